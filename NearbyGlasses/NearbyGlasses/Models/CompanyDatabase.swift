@@ -1,4 +1,5 @@
 import Foundation
+import os
 
 struct CompanyDatabase {
 
@@ -16,6 +17,38 @@ struct CompanyDatabase {
         snapCompanyId
     ]
 
+    // MARK: - Parsing
+
+    /// Reads the little-endian Company ID prefix of manufacturer-specific data in place.
+    /// Returns nil when the payload is shorter than the 2-byte Company ID.
+    static func companyId(fromManufacturerData data: Data) -> UInt16? {
+        guard data.count >= 2 else { return nil }
+        return data.withUnsafeBytes { raw in
+            UInt16(raw[0]) | (UInt16(raw[1]) << 8)
+        }
+    }
+
+    private static let hexDigits = Array("0123456789ABCDEF".utf8)
+
+    /// Formats bytes as space-separated uppercase hex ("AB 01 00"), the same output as
+    /// `String(format: "%02X")` per byte, written through a digit table into a single String.
+    static func hexString(_ data: Data) -> String {
+        guard !data.isEmpty else { return "" }
+        return String(unsafeUninitializedCapacity: data.count * 3 - 1) { buffer in
+            var i = 0
+            for byte in data {
+                if i > 0 {
+                    buffer[i] = 0x20  // space
+                    i += 1
+                }
+                buffer[i] = hexDigits[Int(byte >> 4)]
+                buffer[i + 1] = hexDigits[Int(byte & 0x0F)]
+                i += 2
+            }
+            return i
+        }
+    }
+
     // MARK: - Detection
 
     /// Returns (isMatch, reason) for a given advertisement.
@@ -36,16 +69,8 @@ struct CompanyDatabase {
         }
 
         // 2. Device name pattern match (secondary, typically only seen during pairing)
-        if let name = deviceName?.lowercased() {
-            if name.contains("rayban") {
-                return (true, "Device name contains 'rayban'")
-            }
-            if name.contains("ray-ban") {
-                return (true, "Device name contains 'ray-ban'")
-            }
-            if name.contains("ray ban") {
-                return (true, "Device name contains 'ray ban'")
-            }
+        if let name = deviceName, let pattern = matchingNamePattern(in: name) {
+            return (true, "Device name contains '\(pattern)'")
         }
 
         // 3. Debug override company IDs
@@ -56,6 +81,32 @@ struct CompanyDatabase {
         return (false, "")
     }
 
+    // MARK: - Name Patterns
+
+    static let namePatterns = ["rayban", "ray-ban", "ray ban"]
+
+    /// Upper bound on cached names; the cache is simply emptied when it fills up.
+    private static let maxCachedNames = 256
+    private static let nameMatchCache = OSAllocatedUnfairLock(initialState: [String: String?]())
+
+    /// Returns the first name pattern contained in `name` (case-insensitive), or nil.
+    /// Nearby devices re-advertise the same few names constantly, so results are cached
+    /// per name instead of lowercasing and searching on every advertisement.
+    static func matchingNamePattern(in name: String) -> String? {
+        if let cached = nameMatchCache.withLock({ $0[name] }) {
+            return cached
+        }
+        let lowered = name.lowercased()
+        let match = namePatterns.first { lowered.contains($0) }
+        nameMatchCache.withLock { cache in
+            if cache.count >= maxCachedNames {
+                cache.removeAll(keepingCapacity: true)
+            }
+            cache[name] = match
+        }
+        return match
+    }
+
     // MARK: - Company Name Lookup
 
     static func companyName(for id: UInt16) -> String {
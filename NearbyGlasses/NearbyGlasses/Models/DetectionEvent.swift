@@ -1,9 +1,10 @@
 import Foundation
+import os
 
 struct DetectionEvent: Codable, Identifiable {
-    let id: UUID
+    let id: UInt64
     let timestamp: Date
-    let deviceIdentifier: String  // peripheral.identifier UUID string (NOT a MAC address on iOS)
+    let deviceIdentifier: String  // daily pseudonym of peripheral.identifier (see BLEScanner)
     let deviceName: String?
     let rssi: Int
     let companyId: UInt16?
@@ -20,7 +21,7 @@ struct DetectionEvent: Codable, Identifiable {
         manufacturerDataHex: String?,
         detectionReason: String
     ) {
-        self.id = UUID()
+        self.id = Self.nextID()
         self.timestamp = Date()
         self.deviceIdentifier = deviceIdentifier
         self.deviceName = deviceName
@@ -31,14 +32,37 @@ struct DetectionEvent: Codable, Identifiable {
         self.detectionReason = detectionReason
     }
 
-    var formattedLog: String {
+    /// Shared across events; creating a DateFormatter is far more expensive than using one.
+    /// DateFormatter is thread-safe, so the BLE queue and the main actor can both use it.
+    private static let logTimeFormatter: DateFormatter = {
         let formatter = DateFormatter()
         formatter.dateFormat = "HH:mm:ss"
-        let timeStr = formatter.string(from: timestamp)
+        return formatter
+    }()
+
+    var formattedLog: String {
+        let timeStr = Self.logTimeFormatter.string(from: timestamp)
         let nameStr = deviceName ?? "Unknown Device"
         return "[\(timeStr)] \(nameStr) (\(rssi) dBm) - \(detectionReason)"
     }
 
+    // MARK: - IDs
+
+    /// Time of the first event this session, in whole seconds (static lets initialize lazily on
+    /// first access), placed in the upper 32 bits of every ID from this session.
+    private static let sessionEpoch = UInt64(UInt32(truncatingIfNeeded: Int(Date().timeIntervalSince1970))) << 32
+    private static let sequence = OSAllocatedUnfairLock(initialState: UInt32(0))
+
+    /// Returns a time-sortable ID: session epoch + per-session sequence number.
+    /// Replaces UUID(), which drew 16 random bytes for every detection just to be Identifiable.
+    private static func nextID() -> UInt64 {
+        let seq = sequence.withLock { value -> UInt32 in
+            value &+= 1
+            return value
+        }
+        return sessionEpoch | UInt64(seq)
+    }
+
     var formattedCompanyId: String {
         guard let cid = companyId else { return "N/A" }
         return String(format: "0x%04X", cid)
@@ -1,5 +1,6 @@
 import Foundation
 import CoreBluetooth
+import CryptoKit
 
 // CoreBluetooth option key string literals (top-level constants removed in Xcode 16 / Swift 6).
 // The string values match the underlying Objective-C constants.
@@ -45,12 +46,45 @@ final class BLEScanner: NSObject {
 
     private(set) var isScanning = false
 
+    /// Settings consulted for every advertisement, copied out of UserDefaults so the
+    /// hot path compares plain stored values instead of doing a defaults lookup (and,
+    /// for debug IDs, a string parse) per advertisement. Only accessed on `queue`.
+    private struct FilterSettings {
+        let rssiThreshold: Int
+        let debugEnabled: Bool
+        let advOnly: Bool
+        let debugCompanyIds: Set<UInt16>
+
+        init(_ settings: SettingsManager) {
+            rssiThreshold = settings.rssiThreshold
+            debugEnabled = settings.debugEnabled
+            advOnly = settings.advOnly
+            debugCompanyIds = settings.parsedDebugCompanyIds
+        }
+    }
+
+    private var filter: FilterSettings
+    private var pseudonymizer = IdentifierPseudonymizer()  // only accessed on `queue`
+    private var defaultsObserver: NSObjectProtocol?
+
     // MARK: - Init
 
     init(settings: SettingsManager, notificationService: NotificationService) {
         self.settings = settings
         self.notificationService = notificationService
+        self.filter = FilterSettings(settings)
         super.init()
+        // Refresh the snapshot whenever a setting changes so edits still apply mid-scan.
+        defaultsObserver = NotificationCenter.default.addObserver(
+            forName: UserDefaults.didChangeNotification,
+            object: nil,
+            queue: nil
+        ) { [weak self] _ in
+            guard let self else { return }
+            self.queue.async {
+                self.filter = FilterSettings(self.settings)
+            }
+        }
         // State restoration identifier enables iOS to relaunch the app after suspension.
         centralManager = CBCentralManager(
             delegate: self,
@@ -59,6 +93,12 @@ final class BLEScanner: NSObject {
         )
     }
 
+    deinit {
+        if let defaultsObserver {
+            NotificationCenter.default.removeObserver(defaultsObserver)
+        }
+    }
+
     // MARK: - Scanning Control
 
     func startScanning() {
@@ -126,21 +166,18 @@ extension BLEScanner: CBCentralManagerDelegate {
         rssi RSSI: NSNumber
     ) {
         let rssi = RSSI.intValue
+        let filter = self.filter
 
         // ── Step 1: RSSI threshold filter ──────────────────────────────────────
-        guard rssi >= settings.rssiThreshold else { return }
+        guard rssi >= filter.rssiThreshold else { return }
 
         // ── Step 2: Extract manufacturer-specific data ──────────────────────────
         let mfgData = advertisementData[CBAdvertisementDataManufacturerDataKey] as? Data
 
         // ── Step 3: Parse Company ID (little-endian, first 2 bytes) ─────────────
-        var companyId: UInt16?
-        var manufacturerDataHex: String?
-
-        if let data = mfgData, data.count >= 2 {
-            companyId = UInt16(data[0]) | (UInt16(data[1]) << 8)
-            manufacturerDataHex = data.map { String(format: "%02X", $0) }.joined(separator: " ")
-        }
+        // Read straight from the advertisement's buffer; nothing is copied or
+        // formatted until the advertisement turns out to be a match (Step 8).
+        let companyId = mfgData.flatMap(CompanyDatabase.companyId(fromManufacturerData:))
 
         // ── Step 4: Extract device name ─────────────────────────────────────────
         let deviceName = (advertisementData[CBAdvertisementDataLocalNameKey] as? String)
@@ -148,28 +185,33 @@ extension BLEScanner: CBCentralManagerDelegate {
 
         // ── Step 5: Debug ADV-only filter ───────────────────────────────────────
         // In debug + advOnly mode, skip advertisements without manufacturer data.
-        if settings.debugEnabled && settings.advOnly && mfgData == nil {
+        if filter.debugEnabled && filter.advOnly && mfgData == nil {
             return
         }
 
         // ── Step 6: Debug logging ────────────────────────────────────────────────
-        if settings.debugEnabled {
+        if filter.debugEnabled {
             let idStr = companyId.map { String(format: "0x%04X", $0) } ?? "none"
-            let msg = "DEBUG: ADV addr=\(peripheral.identifier.uuidString) name=\(deviceName ?? "?") rssi=\(rssi) companyId=\(idStr) len=\(mfgData?.count ?? 0)"
+            let addr = pseudonymizer.pseudonym(for: peripheral.identifier)
+            let msg = "DEBUG: ADV addr=\(addr) name=\(deviceName ?? "?") rssi=\(rssi) companyId=\(idStr) len=\(mfgData?.count ?? 0)"
             delegate?.bleScannerDidLog(msg)
         }
 
         // ── Step 7: Smart glasses matching ──────────────────────────────────────
-        let debugIds = settings.parsedDebugCompanyIds
         let (isMatch, reason) = CompanyDatabase.isSmartGlasses(
             companyId: companyId,
             deviceName: deviceName,
-            debugCompanyIds: debugIds
+            debugCompanyIds: filter.debugCompanyIds
         )
 
         guard isMatch else { return }
 
         // ── Step 8: Build and emit DetectionEvent ────────────────────────────────
+        var manufacturerDataHex: String?
+        if let data = mfgData, companyId != nil {
+            manufacturerDataHex = CompanyDatabase.hexString(data)
+        }
+
         let resolvedCompanyName: String
         if let cid = companyId {
             resolvedCompanyName = CompanyDatabase.companyName(for: cid)
@@ -178,7 +220,7 @@ extension BLEScanner: CBCentralManagerDelegate {
         }
 
         let event = DetectionEvent(
-            deviceIdentifier: peripheral.identifier.uuidString,
+            deviceIdentifier: pseudonymizer.pseudonym(for: peripheral.identifier),
             deviceName: deviceName,
             rssi: rssi,
             companyId: companyId,
@@ -202,6 +244,32 @@ extension BLEScanner: CBCentralManagerDelegate {
     }
 }
 
+// MARK: - Identifier Pseudonymization
+
+/// Replaces peripheral identifiers with keyed 64-bit hashes before they reach logs,
+/// events or exports.
+///
+/// The key is random, held only in memory, and replaced when the local date changes.
+/// The same device keeps one pseudonym within a day, but it can't be linked across days
+/// or back to its CoreBluetooth identifier (which is otherwise stable for this phone).
+private struct IdentifierPseudonymizer {
+    private var key = SymmetricKey(size: .bits256)
+    private var keyDay = Calendar.current.startOfDay(for: Date())
+
+    mutating func pseudonym(for identifier: UUID) -> String {
+        let today = Calendar.current.startOfDay(for: Date())
+        if today != keyDay {
+            key = SymmetricKey(size: .bits256)
+            keyDay = today
+        }
+        let bytes = withUnsafeBytes(of: identifier.uuid) { Data($0) }
+        let code = HMAC<SHA256>.authenticationCode(for: bytes, using: key)
+        let value = code.prefix(8).reduce(UInt64(0)) { ($0 << 8) | UInt64($1) }
+        let hex = String(value, radix: 16, uppercase: true)  // same case as Android's pseudonyms
+        return String(repeating: "0", count: 16 - hex.count) + hex
+    }
+}
+
 // MARK: - CBManagerState Description
 
 private extension CBManagerState {
@@ -44,7 +44,7 @@ class NotificationService {
         ]
 
         let request = UNNotificationRequest(
-            identifier: UUID().uuidString,
+            identifier: "detection-\(event.id)",
             content: content,
             trigger: nil   // Deliver immediately
         )
@@ -3,22 +3,61 @@ import Foundation
 
 struct LogExporter {
 
+    private static let filePrefix = "nearby_glasses_detected_"
+
+    /// Exported files are never read back, so only the newest few are kept
+    /// instead of one piling up in the temp directory per export.
+    private static let keptExportCount = 5
+
     /// Writes the log text to a temp file and presents a share sheet from the key window.
     static func export(logText: String) {
         guard !logText.isEmpty else { return }
 
         let timestamp = Int(Date().timeIntervalSince1970)
-        let filename = "nearby_glasses_detected_\(timestamp).txt"
-        let tempURL = FileManager.default.temporaryDirectory
-            .appendingPathComponent(filename)
-
-        do {
-            try logText.write(to: tempURL, atomically: true, encoding: .utf8)
-        } catch {
-            print("LogExporter: failed to write file — \(error)")
-            return
+        let filename = "\(filePrefix)\(timestamp).txt"
+        let directory = FileManager.default.temporaryDirectory
+        let tempURL = directory.appendingPathComponent(filename)
+
+        // Write off the main thread so a long log doesn't stall the UI,
+        // then come back to present the share sheet.
+        DispatchQueue.global(qos: .userInitiated).async {
+            do {
+                // Complete file protection: the export stays encrypted at rest
+                // whenever the device is locked.
+                try Data(logText.utf8).write(to: tempURL, options: [.atomic, .completeFileProtection])
+            } catch {
+                print("LogExporter: failed to write file — \(error)")
+                return
+            }
+            pruneOldExports(in: directory)
+            DispatchQueue.main.async {
+                presentShareSheet(for: tempURL)
+            }
         }
+    }
+
+    /// Deletes all but the `keptExportCount` most recent export files.
+    private static func pruneOldExports(in directory: URL) {
+        let fileManager = FileManager.default
+        guard let files = try? fileManager.contentsOfDirectory(
+            at: directory,
+            includingPropertiesForKeys: [.contentModificationDateKey]
+        ) else { return }
+
+        func modified(_ url: URL) -> Date {
+            (try? url.resourceValues(forKeys: [.contentModificationDateKey]))?
+                .contentModificationDate ?? .distantPast
+        }
+
+        let exports = files
+            .filter { $0.lastPathComponent.hasPrefix(filePrefix) && $0.pathExtension == "txt" }
+            .sorted { modified($0) > modified($1) }
+        for url in exports.dropFirst(keptExportCount) {
+            try? fileManager.removeItem(at: url)
+        }
+    }
 
+    private static func presentShareSheet(for fileURL: URL) {
         guard
             let windowScene = UIApplication.shared.connectedScenes
                 .compactMap({ $0 as? UIWindowScene })
@@ -29,7 +68,7 @@ struct LogExporter {
         }
 
         let activityVC = UIActivityViewController(
-            activityItems: [tempURL],
+            activityItems: [fileURL],
             applicationActivities: nil
         )
 
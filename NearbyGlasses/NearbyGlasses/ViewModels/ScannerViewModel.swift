@@ -1,6 +1,7 @@
 import Foundation
 import CoreBluetooth
 import SwiftUI
+import os
 
 /// Central view model that owns the BLE scanner and notification service.
 /// All published properties are updated on the main actor.
@@ -19,6 +20,24 @@ final class ScannerViewModel: ObservableObject {
     private let bleScanner: BLEScanner
     private let notificationService: NotificationService
 
+    /// Log lines produced on the BLE queue that the main actor hasn't picked up yet.
+    /// The BLE side only appends under the lock and schedules at most one flush at a
+    /// time, so a burst of advertisements becomes a single `logLines` update.
+    private struct PendingLog {
+        var lines: [String] = []
+        var flushScheduled = false
+    }
+
+    private nonisolated let pendingLog = OSAllocatedUnfairLock(initialState: PendingLog())
+
+    /// Upper bound of the Max Log Lines setting. Lines beyond this would be trimmed
+    /// on flush anyway, so the pending buffer keeps only the newest this many.
+    private nonisolated static let maxPendingLogLines = 5_000
+
+    /// How far the pending buffer may grow past `maxPendingLogLines` before it is
+    /// trimmed. Trimming in one chunk keeps the BLE side O(1) per line during a flood.
+    private nonisolated static let pendingLogTrimSlack = 1_000
+
     // MARK: - Init
 
     init() {
@@ -54,6 +73,9 @@ final class ScannerViewModel: ObservableObject {
 
     func clearLog() {
         logLines = []
+        // Drop lines the BLE queue handed over but the main actor hasn't flushed yet.
+        // A flush already scheduled stays scheduled and just finds nothing new.
+        pendingLog.withLock { $0.lines.removeAll() }
     }
 
     var logText: String {
@@ -62,14 +84,42 @@ final class ScannerViewModel: ObservableObject {
 
     // MARK: - Private Helpers
 
-    private func appendLog(_ line: String) {
+    private func appendLog(_ lines: [String]) {
         guard settings.loggingEnabled else { return }
-        logLines.append(line)
+        logLines.append(contentsOf: lines)
         let max = settings.maxLogLines
         if logLines.count > max {
             logLines.removeFirst(logLines.count - max)
         }
     }
+
+    /// Called from the BLE queue.
+    private nonisolated func enqueueLog(_ line: String) {
+        let needsFlush = pendingLog.withLock { state -> Bool in
+            state.lines.append(line)
+            if state.lines.count > Self.maxPendingLogLines + Self.pendingLogTrimSlack {
+                state.lines.removeFirst(state.lines.count - Self.maxPendingLogLines)
+            }
+            guard !state.flushScheduled else { return false }
+            state.flushScheduled = true
+            return true
+        }
+        guard needsFlush else { return }
+        Task { @MainActor in
+            self.flushPendingLog()
+        }
+    }
+
+    private func flushPendingLog() {
+        // Swap the buffer out so the BLE queue keeps appending into a fresh one.
+        let lines = pendingLog.withLock { state -> [String] in
+            var taken: [String] = []
+            swap(&taken, &state.lines)
+            state.flushScheduled = false
+            return taken
+        }
+        appendLog(lines)
+    }
 }
 
 // MARK: - BLEScannerDelegate
@@ -79,15 +129,11 @@ extension ScannerViewModel: BLEScannerDelegate {
     nonisolated func bleScannerDidDetect(_ event: DetectionEvent) {
         // Notification is scheduled directly in BLEScanner on the BLE queue.
         // Only update UI state here.
-        Task { @MainActor in
-            self.appendLog(event.formattedLog)
-        }
+        enqueueLog(event.formattedLog)
     }
 
     nonisolated func bleScannerDidLog(_ message: String) {
-        Task { @MainActor in
-            self.appendLog(message)
-        }
+        enqueueLog(message)
     }
 
     nonisolated func bleScannerStateChanged(isScanning: Bool) {
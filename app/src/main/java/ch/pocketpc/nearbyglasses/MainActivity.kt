@@ -32,6 +32,11 @@ import android.graphics.Color
 import androidx.core.view.updatePadding
 import android.util.TypedValue
 import androidx.core.view.updateLayoutParams
+import androidx.lifecycle.lifecycleScope
+import kotlinx.coroutines.CancellationException
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.withContext
 ///
 import ch.pocketpc.nearbyglasses.databinding.ActivityMainBinding
 import ch.pocketpc.nearbyglasses.model.DetectionEvent
@@ -51,11 +56,20 @@ class MainActivity : AppCompatActivity(), SharedPreferences.OnSharedPreferenceCh
     private lateinit var binding: ActivityMainBinding
     private lateinit var preferencesManager: PreferencesManager
     
-    private val detectionLog = mutableListOf<DetectionEvent>()
+    // Capped at MAX_DETECTION_EVENTS; oldest events are dropped first
+    private val detectionLog = ArrayDeque<DetectionEvent>()
     //private val logTextBuffer = StringBuilder()
     private val logLines = ArrayDeque<String>()   // holds single lines WITHOUT trailing \n
 
     private val dateFormat = SimpleDateFormat("HH:mm:ss", Locale.getDefault())
+
+    // Detections and debug lines can arrive many times per frame; the log text is
+    // rebuilt once per burst instead of once per line.
+    private var logDisplayPending = false
+    private val logDisplayUpdate = Runnable {
+        logDisplayPending = false
+        updateLogDisplay()
+    }
     
     private var scanService: BluetoothScanService? = null
     private var serviceBound = false
@@ -279,7 +293,10 @@ class MainActivity : AppCompatActivity(), SharedPreferences.OnSharedPreferenceCh
     
     private fun addLogEntry(event: DetectionEvent) {
         // Add to log list
-        detectionLog.add(event)
+        detectionLog.addLast(event)
+        if (detectionLog.size > MAX_DETECTION_EVENTS) {
+            detectionLog.removeFirst()
+        }
         
         // Update text log if logging is enabled
         if (!preferencesManager.loggingEnabled) return
@@ -292,10 +309,10 @@ class MainActivity : AppCompatActivity(), SharedPreferences.OnSharedPreferenceCh
             timestamp,
             deviceName,
             event.rssi,
-            event.detectionReason
+            event.detectionReason(this)
         )
         appendLine(line)
-        updateLogDisplay()
+        scheduleLogDisplayUpdate()
 
         /*
         if (preferencesManager.loggingEnabled) {
@@ -336,10 +353,16 @@ class MainActivity : AppCompatActivity(), SharedPreferences.OnSharedPreferenceCh
                 logTextBuffer.append(lines.takeLast(maxLines).joinToString("\n"))
             }
             */
-            updateLogDisplay()
+            scheduleLogDisplayUpdate()
         }
     }
 
+    private fun scheduleLogDisplayUpdate() {
+        if (logDisplayPending) return
+        logDisplayPending = true
+        binding.textLog.post(logDisplayUpdate)
+    }
+
     private fun updateLogDisplay() {
         val show = preferencesManager.loggingEnabled || preferencesManager.debugEnabled
         if (show) {
@@ -510,48 +533,72 @@ class MainActivity : AppCompatActivity(), SharedPreferences.OnSharedPreferenceCh
         }
 
 
-        try {
-            val fileName = "nearby_glasses_detected_${System.currentTimeMillis()}.txt"
-            val file = File(getExternalFilesDir(null), fileName)
-            //FileWriter(file).use { it.write(logTextBuffer.toString()) }
-            FileWriter(file).use { it.write(buildLogText()) }
-
-            shareFile(file, "text/plain")
-
-            /*val fileName = "nearby_glasses_detected_${System.currentTimeMillis()}.json"
-            val file = File(getExternalFilesDir(null), fileName)
+        // Take the text on the UI thread, write the file off it, then share from the UI thread again
+        val logText = buildLogText()
+        lifecycleScope.launch {
+            try {
+                val fileName = "$EXPORT_FILE_PREFIX${System.currentTimeMillis()}.txt"
+                val file = withContext(Dispatchers.IO) {
+                    // Internal cache storage is covered by file-based encryption and is private
+                    // to the app; app-specific external storage is readable by other apps on
+                    // Android 8/9. Earlier exports left there are removed.
+                    val dir = File(cacheDir, EXPORT_DIR).apply { mkdirs() }
+                    File(dir, fileName).also { f ->
+                        //FileWriter(f).use { it.write(logTextBuffer.toString()) }
+                        FileWriter(f).use { it.write(logText) }
+                        pruneOldExports(dir, KEPT_EXPORT_COUNT)
+                        getExternalFilesDir(null)?.let { pruneOldExports(it, 0) }
+                    }
+                }
 
-            val json = buildString {
-                append("{\n")
-                append("  \"export_timestamp\": ${System.currentTimeMillis()},\n")
-                append("  \"total_detections\": ${detectionLog.size},\n")
-                append("  \"detections\": [\n")
-                detectionLog.forEachIndexed { index, event ->
-                    append("    ")
-                    append(event.toJson().replace("\n", "\n    "))
-                    if (index < detectionLog.size - 1) {
-                        append(",")
+                shareFile(file, "text/plain")
+
+                /*val fileName = "nearby_glasses_detected_${System.currentTimeMillis()}.json"
+                val file = File(getExternalFilesDir(null), fileName)
+
+                val json = buildString {
+                    append("{\n")
+                    append("  \"export_timestamp\": ${System.currentTimeMillis()},\n")
+                    append("  \"total_detections\": ${detectionLog.size},\n")
+                    append("  \"detections\": [\n")
+                    detectionLog.forEachIndexed { index, event ->
+                        append("    ")
+                        append(event.toJson(this@MainActivity).replace("\n", "\n    "))
+                        if (index < detectionLog.size - 1) {
+                            append(",")
+                        }
+                        append("\n")
                     }
-                    append("\n")
+                    append("  ]\n")
+                    append("}")
                 }
-                append("  ]\n")
-                append("}")
-            }
             
-            FileWriter(file).use { writer ->
-                writer.write(json)
-            }
+                FileWriter(file).use { writer ->
+                    writer.write(json)
+                }
             
-            shareFile(file)*/
+                shareFile(file)*/
             
-        } catch (e: Exception) {
-            //Log.e(TAG, "Error exporting log", e)
-            Log.e(TAG, getString(R.string.dbg_export_error),e)
-            //Toast.makeText(this, "Error exporting log: ${e.message}", Toast.LENGTH_LONG).show()
-            Toast.makeText(this,getString(R.string.toast_export_error, e.message ?: e.javaClass.simpleName),Toast.LENGTH_LONG).show()
+            } catch (e: CancellationException) {
+                // Activity destroyed mid-export; nothing to report to
+                throw e
+            } catch (e: Exception) {
+                //Log.e(TAG, "Error exporting log", e)
+                Log.e(TAG, getString(R.string.dbg_export_error),e)
+                //Toast.makeText(this, "Error exporting log: ${e.message}", Toast.LENGTH_LONG).show()
+                Toast.makeText(this@MainActivity,getString(R.string.toast_export_error, e.message ?: e.javaClass.simpleName),Toast.LENGTH_LONG).show()
+            }
         }
     }
     
+    // Exported files are never read back; keep only the newest few instead of one per export
+    private fun pruneOldExports(dir: File, keep: Int) {
+        dir.listFiles { f -> f.name.startsWith(EXPORT_FILE_PREFIX) && f.name.endsWith(".txt") }
+            ?.sortedByDescending { it.lastModified() }
+            ?.drop(keep)
+            ?.forEach { it.delete() }
+    }
+
     private fun shareFile(file: File, mimeType: String = "text/plain") {
         val uri = FileProvider.getUriForFile(
             this,
@@ -637,5 +684,11 @@ class MainActivity : AppCompatActivity(), SharedPreferences.OnSharedPreferenceCh
     
     companion object {
         private const val TAG = "MainActivity"
+        // Same as the largest "max log lines" setting; an always-on service
+        // would otherwise keep every detection in memory for as long as it runs.
+        private const val MAX_DETECTION_EVENTS = 5000
+        private const val EXPORT_DIR = "exports"
+        private const val EXPORT_FILE_PREFIX = "nearby_glasses_detected_"
+        private const val KEPT_EXPORT_COUNT = 5
     }
 }
@@ -5,8 +5,9 @@ import ch.pocketpc.nearbyglasses.R
 import android.content.Context
 import android.os.Parcelable
 import kotlinx.parcelize.Parcelize
-import java.text.SimpleDateFormat
-import java.util.Date
+import java.time.Instant
+import java.time.ZoneId
+import java.time.format.DateTimeFormatter
 import java.util.Locale
 
 
@@ -19,36 +20,45 @@ data class DetectionEvent(
     val companyId: String?,
     val companyName: String,
     val manufacturerData: String?,
-    val detectionReason: String
+    val reasons: Int
 ) : Parcelable {
 
-    fun toJson(): String {
-        val dateFormat = SimpleDateFormat("yyyy-MM-dd HH:mm:ss", Locale.getDefault())
+    fun detectionReason(context: Context): String =
+        describeReasons(context, reasons, companyId)
+
+    fun toJson(context: Context): String {
         return """
             {
                 "timestamp": $timestamp,
-                "timestampFormatted": "${dateFormat.format(Date(timestamp))}",
+                "timestampFormatted": "${format(JSON_DATE_FORMAT)}",
                 "deviceAddress": "$deviceAddress",
                 "deviceName": ${deviceName?.let { "\"$it\"" } ?: "null"},
                 "rssi": $rssi,
                 "companyId": ${companyId?.let { "\"$it\"" } ?: "null"},
                 "companyName": "$companyName",
                 "manufacturerData": ${manufacturerData?.let { "\"$it\"" } ?: "null"},
-                "detectionReason": "$detectionReason"
+                "detectionReason": "${detectionReason(context)}"
             }
         """.trimIndent()
     }
 
     fun toLogString(context: Context): String {
-        val dateFormat = SimpleDateFormat("HH:mm:ss", Locale.getDefault())
-        val time = dateFormat.format(Date(timestamp))
+        val time = format(LOG_TIME_FORMAT)
         val name = deviceName ?: context.getString(R.string.unknown_device)
         //return "[$time] ${deviceName ?: "Unknown"} (${rssi}dBm) - $detectionReason"
-        return "[$time] $name (${rssi}dBm) - $detectionReason"
+        return "[$time] $name (${rssi}dBm) - ${detectionReason(context)}"
 
     }
 
+    private fun format(formatter: DateTimeFormatter): String =
+        formatter.format(Instant.ofEpochMilli(timestamp).atZone(ZoneId.systemDefault()))
+
     companion object {
+        // DateTimeFormatter is immutable and thread-safe, so one instance serves every event
+        // (SimpleDateFormat had to be created per call).
+        private val JSON_DATE_FORMAT = DateTimeFormatter.ofPattern("yyyy-MM-dd HH:mm:ss", Locale.getDefault())
+        private val LOG_TIME_FORMAT = DateTimeFormatter.ofPattern("HH:mm:ss", Locale.getDefault())
+
         // Meta Platforms, Inc. (formerly Facebook)
         const val META_COMPANY_ID1 = 0x01AB
         const val META_COMPANY_ID2 = 0x058E
@@ -57,60 +67,108 @@ data class DetectionEvent(
         //Snap (Snapchat) Spectacles
         const val SNAP_COMPANY_ID = 0x03C2
 
-        fun isSmartGlasses(context: Context, companyId: Int?,deviceName: String?): Pair<Boolean, String>
-        {
-            val reasons = mutableListOf<String>()
+        // Detection reasons are kept as bits on the event and only turned into
+        // localized text when shown or exported (see describeReasons).
+        const val REASON_META_COMPANY_ID1 = 1 shl 0
+        const val REASON_META_COMPANY_ID2 = 1 shl 1
+        const val REASON_ESSILOR_COMPANY_ID = 1 shl 2
+        const val REASON_SNAP_COMPANY_ID = 1 shl 3
+        const val REASON_NAME_RAYBAN = 1 shl 4
+        const val REASON_NAME_RAY_DASH_BAN = 1 shl 5
+        const val REASON_NAME_RAY_SPACE_BAN = 1 shl 6
+        const val REASON_DEBUG_OVERRIDE = 1 shl 7
+
+        /** Returns the REASON_* bits matching this advertisement, or 0 if it's not smart glasses. */
+        fun matchReasons(companyId: Int?, deviceName: String?): Int {
+            var reasons = 0
 
             // Check company ID
-            if (companyId == META_COMPANY_ID1) {
-                //reasons.add("Meta Company ID (0x01AB)")
-                reasons.add(context.getString(
-                    R.string.reason_meta_company_id,
-                    "0x01AB"))
-            }
-            if (companyId == META_COMPANY_ID2) {
-                //reasons.add("Meta Company ID (0x058E)")
-                reasons.add(context.getString(
-                    R.string.reason_meta_company_id,
-                    "0x058E"))
+            when (companyId) {
+                META_COMPANY_ID1 -> reasons = reasons or REASON_META_COMPANY_ID1
+                META_COMPANY_ID2 -> reasons = reasons or REASON_META_COMPANY_ID2
+                ESSILOR_COMPANY_ID -> reasons = reasons or REASON_ESSILOR_COMPANY_ID
+                SNAP_COMPANY_ID -> reasons = reasons or REASON_SNAP_COMPANY_ID
             }
 
-            if (companyId == ESSILOR_COMPANY_ID) {
-                //reasons.add("EssilorLuxottica Company ID (0x0D53)")
-                reasons.add(context.getString(
-                    R.string.reason_essilor_company_id,
-                    "0x0D53"))
+            // Check device name
+            deviceName?.let { name ->
+                reasons = reasons or nameReasons(name)
             }
 
-            if (companyId == SNAP_COMPANY_ID) {
-                //reasons.add("Snap Company ID (0x03C2)")
-                reasons.add(context.getString(
-                    R.string.reason_snap_company_id,
-                    "0x03C2"))
+            return reasons
+        }
+
+        private const val MAX_CACHED_NAMES = 256
+
+        // Access-ordered, so the least recently seen name is dropped first once full.
+        private val nameReasonCache =
+            object : LinkedHashMap<String, Int>(MAX_CACHED_NAMES, 0.75f, true) {
+                override fun removeEldestEntry(eldest: MutableMap.MutableEntry<String, Int>?) =
+                    size > MAX_CACHED_NAMES
             }
 
-            // Check device name
-            deviceName?.let { name ->
+        // Nearby devices re-advertise the same few names constantly, so the
+        // lowercase + pattern search is done once per name and cached.
+        private fun nameReasons(name: String): Int = synchronized(nameReasonCache) {
+            nameReasonCache.getOrPut(name) {
                 val nameLower = name.lowercase()
                 when {
-                    //nameLower.contains("rayban") -> reasons.add("Device name contains 'rayban'")
-                    //nameLower.contains("ray-ban") -> reasons.add("Device name contains 'ray-ban'")
-                    //nameLower.contains("ray ban") -> reasons.add("Device name contains 'ray ban'")
-
-                    nameLower.contains("rayban") -> reasons.add(
-                        context.getString(R.string.reason_name_contains,"rayban")
-                    )
-                    nameLower.contains("ray-ban") -> reasons.add(
-                        context.getString(R.string.reason_name_contains,"ray-ban")
-                    )
-                    nameLower.contains("ray ban") -> reasons.add(
-                        context.getString(R.string.reason_name_contains,"ray ban")
-                    )
-                else -> {} // do nothing
+                    nameLower.contains("rayban") -> REASON_NAME_RAYBAN
+                    nameLower.contains("ray-ban") -> REASON_NAME_RAY_DASH_BAN
+                    nameLower.contains("ray ban") -> REASON_NAME_RAY_SPACE_BAN
+                    else -> 0
                 }
             }
+        }
+
+        /**
+         * Renders REASON_* bits as localized text, e.g. "Meta Company ID (0x01AB)".
+         * [companyId] is the formatted ID ("0x1234"), only used for the debug override text.
+         */
+        fun describeReasons(context: Context, reasons: Int, companyId: String?): String {
+            fun has(bit: Int) = (reasons and bit) != 0
+
+            // A debug override replaces any other reason
+            if (has(REASON_DEBUG_OVERRIDE)) {
+                return context.getString(R.string.reason_debug_override_company_id, companyId ?: "")
+            }
 
-            return Pair(reasons.isNotEmpty(), reasons.joinToString(", "))
+            val parts = ArrayList<String>(2)
+            if (has(REASON_META_COMPANY_ID1)) {
+                parts.add(context.getString(R.string.reason_meta_company_id, "0x01AB"))
+            }
+            if (has(REASON_META_COMPANY_ID2)) {
+                parts.add(context.getString(R.string.reason_meta_company_id, "0x058E"))
+            }
+            if (has(REASON_ESSILOR_COMPANY_ID)) {
+                parts.add(context.getString(R.string.reason_essilor_company_id, "0x0D53"))
+            }
+            if (has(REASON_SNAP_COMPANY_ID)) {
+                parts.add(context.getString(R.string.reason_snap_company_id, "0x03C2"))
+            }
+            if (has(REASON_NAME_RAYBAN)) {
+                parts.add(context.getString(R.string.reason_name_contains, "rayban"))
+            }
+            if (has(REASON_NAME_RAY_DASH_BAN)) {
+                parts.add(context.getString(R.string.reason_name_contains, "ray-ban"))
+            }
+            if (has(REASON_NAME_RAY_SPACE_BAN)) {
+                parts.add(context.getString(R.string.reason_name_contains, "ray ban"))
+            }
+            return parts.joinToString(", ")
+        }
+
+        private val HEX_DIGITS = "0123456789ABCDEF".toCharArray()
+
+        /** Uppercase hex without separators ("AB0100"), same as "%02X" per byte but without a String per byte. */
+        fun toHex(bytes: ByteArray): String {
+            val out = CharArray(bytes.size * 2)
+            for (i in bytes.indices) {
+                val v = bytes[i].toInt() and 0xFF
+                out[i * 2] = HEX_DIGITS[v ushr 4]
+                out[i * 2 + 1] = HEX_DIGITS[v and 0x0F]
+            }
+            return String(out)
         }
 
         fun getCompanyName(context: Context, companyId: Int): String {
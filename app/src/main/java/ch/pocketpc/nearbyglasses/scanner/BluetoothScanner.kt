@@ -13,6 +13,7 @@ import android.content.Context
 import android.os.Build
 import android.util.Log
 import ch.pocketpc.nearbyglasses.model.DetectionEvent
+import ch.pocketpc.nearbyglasses.util.AddressPseudonymizer
 import kotlinx.coroutines.flow.MutableStateFlow
 import kotlinx.coroutines.flow.StateFlow
 import android.Manifest
@@ -124,37 +125,53 @@ class BluetoothScanner(
     }
     private var lastUiDebugAt = 0L
 
-    private fun dThrottled(msg: String, minIntervalMs: Long = 250) {
+    // msg is only built when it will actually be delivered
+    private inline fun dThrottled(minIntervalMs: Long = 250, msg: () -> String) {
         if (!debugEnabled) return
         val now = System.currentTimeMillis()
         if (now - lastUiDebugAt < minIntervalMs) return
         lastUiDebugAt = now
-        onDebugLog?.invoke(msg)
+        onDebugLog?.invoke(msg())
     }
 
+    private fun debugName(deviceName: String?): String =
+        deviceName ?: context.getString(R.string.dbg_placeholder_unknown)
+
+    private fun debugCompanyId(companyId: Int?): String =
+        companyId?.let { "0x%04X".format(it) } ?: context.getString(R.string.dbg_placeholder_none)
+
+    // Raw addresses never leave the scanner; logs, events and exports get a daily pseudonym.
+    private fun deviceAddress(result: ScanResult): String =
+        AddressPseudonymizer.pseudonymize(result.device.address)
+
+    // Only asked when the scan record carries no name, so unnamed advertisements
+    // don't pay for a permission lookup each time.
+    private fun canReadDeviceIdentity(): Boolean =
+        Build.VERSION.SDK_INT < Build.VERSION_CODES.S ||
+                ContextCompat.checkSelfPermission(context, Manifest.permission.BLUETOOTH_CONNECT) == PackageManager.PERMISSION_GRANTED
+
     private fun processScanResult(result: ScanResult) {
-        val deviceAddress = result.device.address
-        // Check RSSI threshold
+        // Hashed at most once per advertisement, and only if a log line or event needs it
+        val address by lazy(LazyThreadSafetyMode.NONE) { deviceAddress(result) }
+
+        // Check RSSI threshold first: most advertisements stop here, so nothing
+        // else is read from the ScanResult for them.
         if (result.rssi < rssiThreshold) {
             if (debugEnabled) {
                 //Log.d(TAG, "Filtered by RSSI: ${result.device.address} rssi=${result.rssi}")
-                Log.d(TAG,context.getString(R.string.dbg_filtered_rssi,result.device.address, result.rssi)
-                )
+                val msg = context.getString(R.string.dbg_filtered_rssi, address, result.rssi)
+                Log.d(TAG, msg)
                 //d("Filtered RSSI addr=${result.device.address} rssi=${result.rssi}")
-                d(context.getString(R.string.dbg_filtered_rssi,result.device.address, result.rssi))
+                d(msg)
             }
             return
         }
-        val canReadDeviceIdentity =
-            Build.VERSION.SDK_INT < Build.VERSION_CODES.S ||
-                    ContextCompat.checkSelfPermission(context, Manifest.permission.BLUETOOTH_CONNECT) == PackageManager.PERMISSION_GRANTED
-
         val deviceName: String? = when {
             // Prefer scan record name (doesn't require CONNECT)
             !result.scanRecord?.deviceName.isNullOrBlank() -> result.scanRecord?.deviceName
 
             // Only touch device.alias if CONNECT is granted
-            canReadDeviceIdentity && Build.VERSION.SDK_INT >= Build.VERSION_CODES.R -> {
+            Build.VERSION.SDK_INT >= Build.VERSION_CODES.R && canReadDeviceIdentity() -> {
                 try { result.device.alias } catch (_: SecurityException) { null }
             }
 
@@ -168,47 +185,39 @@ class BluetoothScanner(
         
         val manufacturerData = result.scanRecord?.manufacturerSpecificData
         var companyId: Int? = null
-        var manufacturerDataHex: String? = null
+        var manufacturerPayload: ByteArray? = null
         
-        // Extract company ID from manufacturer data
+        // Extract company ID from manufacturer data.
+        // The payload is only borrowed here; it is hex-encoded once we know it's a match.
         if (manufacturerData != null && manufacturerData.size() > 0) {
             companyId = manufacturerData.keyAt(0)
-            val data = manufacturerData.valueAt(0)
-            manufacturerDataHex = data.joinToString("") { "%02X".format(it) }
+            manufacturerPayload = manufacturerData.valueAt(0)
         }
+        val manufacturerDataLen = manufacturerPayload?.size ?: 0
         //just d(...) is to fast for most UI
         //val companyIdStr = companyId?.let { "0x%04X".format(it) } ?: "none"
         //dThrottled("ADV addr=$deviceAddress name=${deviceName ?: "?"} rssi=${result.rssi} companyId=$companyIdStr")
         //dThrottled("ADV addr=$deviceAddress name=${deviceName ?: "?"} " + "rssi=${result.rssi} companyId=$companyIdStr len=${manufacturerDataHex?.length?.div(2) ?: 0}")
-        val nameSafe = deviceName ?: context.getString(R.string.dbg_placeholder_unknown)
-        val companySafe = companyId?.let { "0x%04X".format(it) }
-            ?: context.getString(R.string.dbg_placeholder_none)
-        dThrottled(
+        dThrottled {
             context.getString(
                 R.string.dbg_adv_short,
-                deviceAddress,
-                nameSafe,
+                address,
+                debugName(deviceName),
                 result.rssi,
-                companySafe,
-                manufacturerDataHex?.length?.div(2) ?: 0
+                debugCompanyId(companyId),
+                manufacturerDataLen
             )
-        )
+        }
 
         // for to check if this is a smart glasses device (including our debug override)
-        val (isSmartGlassesReal, reasonReal) = DetectionEvent.isSmartGlasses(context,companyId, deviceName)
+        val realReasons = DetectionEvent.matchReasons(companyId, deviceName)
         //val overrideMatch = companyId != null && debugCompanyIds.contains(companyId)
         //only when debug is on AND company IDs are entered
         val overrideMatch = debugEnabled && companyId != null && debugCompanyIds.contains(companyId)
 
-        val isSmartGlasses = isSmartGlassesReal || overrideMatch
-        val reason = when {
-            //overrideMatch -> "Debug override: Company ID 0x%04X matched".format(companyId)
-            overrideMatch -> context.getString(
-                R.string.reason_debug_override_company_id,
-                "0x%04X".format(companyId)
-            )
-            else -> reasonReal
-        }
+        // reason text is only rendered when shown (debug log, UI, notification, export)
+        val reasons = if (overrideMatch) DetectionEvent.REASON_DEBUG_OVERRIDE else realReasons
+        val isSmartGlasses = reasons != 0
 
         if (debugEnabled) {
             /*Log.d(
@@ -222,21 +231,22 @@ class BluetoothScanner(
                 TAG,
                 context.getString(
                     R.string.dbg_adv_full,
-                    deviceAddress,
-                    nameSafe,
+                    address,
+                    debugName(deviceName),
                     result.rssi,
-                    companySafe,
-                    manufacturerDataHex?.length?.div(2) ?: 0,
+                    debugCompanyId(companyId),
+                    manufacturerDataLen,
                     isSmartGlasses,
-                    reason
+                    DetectionEvent.describeReasons(context, reasons, debugCompanyId(companyId))
                 )
             )
         }
 
         if (isSmartGlasses) {
+            val manufacturerDataHex = manufacturerPayload?.let { DetectionEvent.toHex(it) }
             val event = DetectionEvent(
                 timestamp = System.currentTimeMillis(),
-                deviceAddress = deviceAddress,
+                deviceAddress = address,
                 deviceName = deviceName,
                 rssi = result.rssi,
                 companyId = companyId?.let { "0x${String.format("%04X", it)}" },
@@ -244,7 +254,7 @@ class BluetoothScanner(
                 companyName = companyId?.let { DetectionEvent.getCompanyName(context, it) }
                     ?: context.getString(R.string.company_unknown_plain),
                 manufacturerData = manufacturerDataHex,
-                detectionReason = reason
+                reasons = reasons
             )
             
             //Log.d(TAG, "smart glasses detected: ${event.deviceName} (${event.rssi} dBm)")
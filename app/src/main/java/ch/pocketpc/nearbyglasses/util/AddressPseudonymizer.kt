@@ -0,0 +1,42 @@
+package ch.pocketpc.nearbyglasses.util
+
+import ch.pocketpc.nearbyglasses.model.DetectionEvent
+import java.security.SecureRandom
+import java.time.LocalDate
+import javax.crypto.Mac
+import javax.crypto.spec.SecretKeySpec
+
+/**
+ * Replaces Bluetooth device addresses with keyed 64-bit hashes before they
+ * reach logs, events or exports.
+ *
+ * The key is random, held only in memory, and replaced when the local date
+ * changes. The same device keeps one pseudonym within a day, so detections can
+ * still be correlated, but it can't be linked across days or back to its address.
+ */
+object AddressPseudonymizer {
+    private const val ALGORITHM = "HmacSHA256"
+    private const val KEY_BYTES = 32
+    private const val PSEUDONYM_BYTES = 8
+
+    private val random = SecureRandom()
+    private var keyDay: LocalDate? = null
+    private var mac: Mac? = null
+
+    /** Returns a 16-hex-digit pseudonym for [address], stable for the current day. */
+    @Synchronized
+    fun pseudonymize(address: String): String {
+        val today = LocalDate.now()
+        val currentMac = mac.takeIf { keyDay == today } ?: newMac().also {
+            mac = it
+            keyDay = today
+        }
+        val digest = currentMac.doFinal(address.toByteArray(Charsets.US_ASCII))
+        return DetectionEvent.toHex(digest.copyOf(PSEUDONYM_BYTES))
+    }
+
+    private fun newMac(): Mac {
+        val key = ByteArray(KEY_BYTES).also { random.nextBytes(it) }
+        return Mac.getInstance(ALGORITHM).apply { init(SecretKeySpec(key, ALGORITHM)) }
+    }
+}
@@ -94,7 +94,7 @@ class NotificationHelper(private val context: Context) {
                             R.string.notification_bigtext,
                             deviceName,
                             event.rssi,
-                            event.detectionReason,
+                            event.detectionReason(context),
                             event.companyName
                         )
                     )
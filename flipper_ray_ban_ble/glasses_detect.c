@@ -0,0 +1,152 @@
+/**
+ * Smart glasses detection core — see glasses_detect.h
+ */
+
+#include "glasses_detect.h"
+
+// ---------------------------------------------------------------------------
+// Tables
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    uint16_t    company_id;
+    uint32_t    reason;
+    const char* name;
+} CompanyEntry;
+
+static const CompanyEntry kCompanies[] = {
+    {GLASSES_CID_META_INC,  GlassesReasonMetaInc,   "Meta Platforms, Inc."},
+    {GLASSES_CID_META_TECH, GlassesReasonMetaTech,  "Meta Platforms Tech"},
+    {GLASSES_CID_LUXOTTICA, GlassesReasonLuxottica, "EssilorLuxottica"},
+    {GLASSES_CID_SNAP,      GlassesReasonSnap,      "Snapchat, Inc."},
+};
+
+#define COMPANY_COUNT (sizeof(kCompanies) / sizeof(kCompanies[0]))
+
+typedef struct {
+    const char* pattern; // lowercase ASCII
+    uint8_t     len;
+    uint32_t    reason;
+} NamePattern;
+
+// Checked in order, first hit wins (same as the apps)
+static const NamePattern kNamePatterns[] = {
+    {"rayban",  6, GlassesReasonNameRayban},
+    {"ray-ban", 7, GlassesReasonNameRayDashBan},
+    {"ray ban", 7, GlassesReasonNameRaySpaceBan},
+};
+
+#define NAME_PATTERN_COUNT (sizeof(kNamePatterns) / sizeof(kNamePatterns[0]))
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+static uint8_t ascii_lower(uint8_t c) {
+    return (c >= 'A' && c <= 'Z') ? (uint8_t)(c + ('a' - 'A')) : c;
+}
+
+// Case-insensitive substring search; `pattern` must already be lowercase.
+static bool name_contains(const uint8_t* name, uint8_t name_len, const NamePattern* p) {
+    if(p->len > name_len) return false;
+
+    for(uint8_t start = 0; start <= name_len - p->len; start++) {
+        uint8_t i = 0;
+        while(i < p->len && ascii_lower(name[start + i]) == (uint8_t)p->pattern[i]) {
+            i++;
+        }
+        if(i == p->len) return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// API
+// ---------------------------------------------------------------------------
+
+bool glasses_parse_adv(const uint8_t* data, size_t len, GlassesAdv* out) {
+    out->has_company_id = false;
+    out->company_id     = 0;
+    out->mfg_len        = 0;
+    out->name           = NULL;
+    out->name_len       = 0;
+
+    bool have_complete_name = false;
+    size_t pos              = 0;
+
+    while(pos < len) {
+        uint8_t field_len = data[pos];
+        if(field_len == 0) break; // early termination / zero padding
+        if(pos + 1 + field_len > len) return false;
+
+        uint8_t        type      = data[pos + 1];
+        const uint8_t* value     = &data[pos + 2];
+        uint8_t        value_len = (uint8_t)(field_len - 1);
+
+        switch(type) {
+        case GLASSES_AD_TYPE_MANUFACTURER:
+            if(!out->has_company_id && value_len >= 2) {
+                out->has_company_id = true;
+                out->company_id     = (uint16_t)(value[0] | (value[1] << 8));
+                out->mfg_len        = value_len;
+            }
+            break;
+        case GLASSES_AD_TYPE_COMPLETE_NAME:
+            if(!have_complete_name) {
+                out->name          = value;
+                out->name_len      = value_len;
+                have_complete_name = true;
+            }
+            break;
+        case GLASSES_AD_TYPE_SHORT_NAME:
+            if(out->name == NULL) {
+                out->name     = value;
+                out->name_len = value_len;
+            }
+            break;
+        default:
+            break;
+        }
+
+        pos += 1 + field_len;
+    }
+
+    return true;
+}
+
+uint32_t glasses_match(const GlassesAdv* adv) {
+    uint32_t reasons = GlassesReasonNone;
+
+    if(adv->has_company_id) {
+        for(size_t i = 0; i < COMPANY_COUNT; i++) {
+            if(kCompanies[i].company_id == adv->company_id) {
+                reasons |= kCompanies[i].reason;
+                break;
+            }
+        }
+    }
+
+    if(adv->name != NULL) {
+        for(size_t i = 0; i < NAME_PATTERN_COUNT; i++) {
+            if(name_contains(adv->name, adv->name_len, &kNamePatterns[i])) {
+                reasons |= kNamePatterns[i].reason;
+                break;
+            }
+        }
+    }
+
+    return reasons;
+}
+
+uint32_t glasses_detect_adv(const uint8_t* data, size_t len) {
+    GlassesAdv adv;
+    glasses_parse_adv(data, len, &adv);
+    return glasses_match(&adv);
+}
+
+const char* glasses_company_name(uint16_t company_id) {
+    for(size_t i = 0; i < COMPANY_COUNT; i++) {
+        if(kCompanies[i].company_id == company_id) return kCompanies[i].name;
+    }
+    return NULL;
+}
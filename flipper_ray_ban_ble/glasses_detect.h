@@ -0,0 +1,75 @@
+/**
+ * Smart glasses detection core
+ *
+ * The same Company ID and device-name checks as the NearbyGlasses iOS and
+ * Android apps, written for small targets: plain C99, no heap, no floating
+ * point, no recursion and no libc beyond the freestanding headers. It builds
+ * unchanged inside the Flipper app, on BLE MCU sensor nodes and on a Linux
+ * host.
+ *
+ * All inputs are borrowed. The parser returns pointers into the caller's
+ * advertisement buffer and never copies it.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Bluetooth SIG assigned Company IDs of known smart glasses manufacturers
+#define GLASSES_CID_META_INC  0x01ABu // Meta Platforms, Inc. — Ray-Ban Meta
+#define GLASSES_CID_META_TECH 0x058Eu // Meta Platforms Technologies, LLC
+#define GLASSES_CID_LUXOTTICA 0x0D53u // EssilorLuxottica (manufactures Ray-Bans)
+#define GLASSES_CID_SNAP      0x03C2u // Snapchat, Inc. — Snap Spectacles
+
+// Legacy advertising payload limit
+#define GLASSES_ADV_MAX_LEN 31
+
+// AD types used by the parser
+#define GLASSES_AD_TYPE_SHORT_NAME    0x08
+#define GLASSES_AD_TYPE_COMPLETE_NAME 0x09
+#define GLASSES_AD_TYPE_MANUFACTURER  0xFF
+
+/**
+ * Why an advertisement matched. Bits are combined when both the Company ID and
+ * the name match. The order is the same as the Android REASON_* bits.
+ */
+typedef enum {
+    GlassesReasonNone            = 0,
+    GlassesReasonMetaInc         = 1 << 0,
+    GlassesReasonMetaTech        = 1 << 1,
+    GlassesReasonLuxottica       = 1 << 2,
+    GlassesReasonSnap            = 1 << 3,
+    GlassesReasonNameRayban      = 1 << 4, // "rayban"
+    GlassesReasonNameRayDashBan  = 1 << 5, // "ray-ban"
+    GlassesReasonNameRaySpaceBan = 1 << 6, // "ray ban"
+} GlassesReason;
+
+typedef struct {
+    bool           has_company_id;
+    uint16_t       company_id; // little-endian prefix of manufacturer data
+    uint8_t        mfg_len;    // manufacturer data length, including the Company ID
+    const uint8_t* name;       // borrowed, not NUL-terminated; NULL if absent
+    uint8_t        name_len;
+} GlassesAdv;
+
+/**
+ * Walks the AD structures of a raw advertisement payload.
+ *
+ * Fills `out` with the first manufacturer-specific Company ID and the local
+ * name. A complete name is preferred over a shortened one.
+ *
+ * @return false if an AD structure runs past `len`. Fields parsed before that
+ *         point are still valid.
+ */
+bool glasses_parse_adv(const uint8_t* data, size_t len, GlassesAdv* out);
+
+/** Returns the GlassesReason bits for a parsed advertisement (0 = no match). */
+uint32_t glasses_match(const GlassesAdv* adv);
+
+/** Convenience: parse + match in one call. */
+uint32_t glasses_detect_adv(const uint8_t* data, size_t len);
+
+/** Short manufacturer label for a Company ID, or NULL if it's not a known one. */
+const char* glasses_company_name(uint16_t company_id);
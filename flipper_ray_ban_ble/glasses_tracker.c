@@ -0,0 +1,120 @@
+/**
+ * Per-device detection table — see glasses_tracker.h
+ */
+
+#include "glasses_tracker.h"
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+static bool addr_equal(const uint8_t* a, const uint8_t* b) {
+    for(uint8_t i = 0; i < GLASSES_ADDR_LEN; i++) {
+        if(a[i] != b[i]) return false;
+    }
+    return true;
+}
+
+// Existing entry for `addr`, else a free slot, else the least recently seen entry
+static GlassesDevice* find_slot(GlassesTracker* tracker, const uint8_t* addr, uint32_t now_ms) {
+    GlassesDevice* free_slot = NULL;
+    GlassesDevice* oldest    = &tracker->devices[0];
+
+    for(size_t i = 0; i < GLASSES_TRACKER_CAPACITY; i++) {
+        GlassesDevice* d = &tracker->devices[i];
+        if(!d->used) {
+            if(free_slot == NULL) free_slot = d;
+            continue;
+        }
+        if(addr_equal(d->addr, addr)) return d;
+        // Compare ages, not timestamps, so the choice survives tick counter wrap-around
+        if(oldest->used && now_ms - d->last_seen_ms > now_ms - oldest->last_seen_ms) oldest = d;
+    }
+
+    return free_slot != NULL ? free_slot : oldest;
+}
+
+// ---------------------------------------------------------------------------
+// API
+// ---------------------------------------------------------------------------
+
+void glasses_tracker_init(GlassesTracker* tracker) {
+    for(size_t i = 0; i < GLASSES_TRACKER_CAPACITY; i++) {
+        tracker->devices[i].used = false;
+    }
+    tracker->total_hits = 0;
+}
+
+uint32_t glasses_tracker_feed(GlassesTracker* tracker, const GlassesAdvReport* report, uint32_t now_ms) {
+    // `len` comes from the adapter; never read past the report's own buffer
+    size_t len = report->len > GLASSES_ADV_MAX_LEN ? GLASSES_ADV_MAX_LEN : report->len;
+
+    GlassesAdv adv;
+    glasses_parse_adv(report->data, len, &adv);
+    uint32_t reasons = glasses_match(&adv);
+    if(reasons == GlassesReasonNone) return reasons;
+
+    int16_t rssi_q4  = (int16_t)(report->rssi * (1 << GLASSES_RSSI_Q4_SHIFT));
+    GlassesDevice* d = find_slot(tracker, report->addr, now_ms);
+
+    if(!d->used || !addr_equal(d->addr, report->addr)) {
+        // New device (or evicting the stalest one)
+        for(uint8_t i = 0; i < GLASSES_ADDR_LEN; i++) d->addr[i] = report->addr[i];
+        d->used    = true;
+        d->rssi_q4 = rssi_q4;
+        d->hits    = 0;
+    } else {
+        // EMA with alpha = 1/4; division keeps rounding symmetric for negative dBm
+        d->rssi_q4 = (int16_t)(d->rssi_q4 + (rssi_q4 - d->rssi_q4) / 4);
+    }
+
+    d->company_id   = adv.has_company_id ? adv.company_id : 0;
+    d->reasons      = reasons;
+    d->rssi_last    = report->rssi;
+    d->last_seen_ms = now_ms;
+    d->hits++;
+    tracker->total_hits++;
+
+    return reasons;
+}
+
+size_t glasses_tracker_drain(GlassesTracker* tracker, GlassesAdvSource source, void* ctx, uint32_t now_ms) {
+    if(source == NULL) return 0;
+
+    GlassesAdvReport report;
+    size_t count = 0;
+    while(count < GLASSES_TRACKER_MAX_REPORTS_PER_FRAME && source(ctx, &report)) {
+        glasses_tracker_feed(tracker, &report, now_ms);
+        count++;
+    }
+    return count;
+}
+
+void glasses_tracker_expire(GlassesTracker* tracker, uint32_t now_ms, uint32_t max_age_ms) {
+    for(size_t i = 0; i < GLASSES_TRACKER_CAPACITY; i++) {
+        GlassesDevice* d = &tracker->devices[i];
+        // Unsigned subtraction stays correct across tick counter wrap-around
+        if(d->used && now_ms - d->last_seen_ms > max_age_ms) d->used = false;
+    }
+}
+
+size_t glasses_tracker_top(const GlassesTracker* tracker, const GlassesDevice** out, size_t max) {
+    size_t count = 0;
+
+    // Insertion into a short sorted list: CAPACITY x N comparisons at most
+    for(size_t i = 0; i < GLASSES_TRACKER_CAPACITY; i++) {
+        const GlassesDevice* d = &tracker->devices[i];
+        if(!d->used) continue;
+
+        size_t pos = count;
+        while(pos > 0 && out[pos - 1]->rssi_q4 < d->rssi_q4) pos--;
+        if(pos >= max) continue;
+
+        size_t last = (count < max) ? count : max - 1;
+        for(size_t j = last; j > pos; j--) out[j] = out[j - 1];
+        out[pos] = d;
+        if(count < max) count++;
+    }
+
+    return count;
+}
@@ -0,0 +1,80 @@
+/**
+ * Per-device detection table for the receive-side (detector) mode
+ *
+ * Keeps a fixed-size table of smart glasses seen recently, keyed by
+ * advertiser address. From it the screen takes a top-N list, strongest
+ * signal first. Like glasses_detect.c this is plain C99 with no heap and no
+ * floating point, so it can be exercised on a Linux host through a shim
+ * advertisement source.
+ */
+
+#pragma once
+
+#include "glasses_detect.h"
+
+#define GLASSES_ADDR_LEN 6
+
+// Devices remembered at once; the least recently seen one is replaced when full
+#define GLASSES_TRACKER_CAPACITY 16
+
+// Rows that fit between the title and footer on the 128x64 screen
+#define GLASSES_TRACKER_TOP_N 4
+
+// Reports handled per UI frame, so one busy frame can't stall the event loop
+#define GLASSES_TRACKER_MAX_REPORTS_PER_FRAME 32
+
+// Devices not seen for this long drop out of the list
+#define GLASSES_TRACKER_MAX_AGE_MS 30000
+
+// Smoothed RSSI is stored as dBm * 16
+#define GLASSES_RSSI_Q4_SHIFT 4
+
+/** One raw advertisement, as delivered by a platform adapter. */
+typedef struct {
+    uint8_t addr[GLASSES_ADDR_LEN];
+    int8_t  rssi;
+    uint8_t len;   // clamped to GLASSES_ADV_MAX_LEN by the tracker
+    uint8_t data[GLASSES_ADV_MAX_LEN];
+} GlassesAdvReport;
+
+/**
+ * Platform adapter: fills `out` with the next pending advertisement.
+ * Returns false when nothing is pending. Must not block.
+ */
+typedef bool (*GlassesAdvSource)(void* ctx, GlassesAdvReport* out);
+
+typedef struct {
+    bool     used;
+    uint8_t  addr[GLASSES_ADDR_LEN];
+    uint16_t company_id;   // 0 if the match was by name only
+    uint32_t reasons;      // GlassesReason bits
+    int16_t  rssi_q4;      // exponentially smoothed RSSI, dBm * 16
+    int8_t   rssi_last;
+    uint32_t hits;
+    uint32_t last_seen_ms;
+} GlassesDevice;
+
+typedef struct {
+    GlassesDevice devices[GLASSES_TRACKER_CAPACITY];
+    uint32_t      total_hits;
+} GlassesTracker;
+
+void glasses_tracker_init(GlassesTracker* tracker);
+
+/**
+ * Runs detection on one advertisement and records it if it matches.
+ * @return the GlassesReason bits (0 = not smart glasses, not recorded)
+ */
+uint32_t glasses_tracker_feed(GlassesTracker* tracker, const GlassesAdvReport* report, uint32_t now_ms);
+
+/** Pulls at most GLASSES_TRACKER_MAX_REPORTS_PER_FRAME reports from `source`. */
+size_t glasses_tracker_drain(GlassesTracker* tracker, GlassesAdvSource source, void* ctx, uint32_t now_ms);
+
+/** Forgets devices last seen more than `max_age_ms` before `now_ms`. */
+void glasses_tracker_expire(GlassesTracker* tracker, uint32_t now_ms, uint32_t max_age_ms);
+
+/**
+ * Fills `out` with up to `max` tracked devices, strongest smoothed RSSI first.
+ * @return number of entries written
+ */
+size_t glasses_tracker_top(const GlassesTracker* tracker, const GlassesDevice** out, size_t max);
@@ -0,0 +1,94 @@
+/**
+ * Host check for the detection core — see glasses_detect.h
+ *
+ * Runs glasses_detect_adv on the packets the emulator broadcasts and on a few
+ * edge cases, and checks the GlassesReason bits against what the NearbyGlasses
+ * apps report for the same advertisements.
+ *
+ *   gcc -std=c99 -Wall -Wextra -Werror -I.. ../glasses_detect.c test_detect.c -o test_detect
+ */
+
+#include <stdio.h>
+
+#include "glasses_detect.h"
+
+static int failures = 0;
+
+#define CHECK_REASONS(label, data, expected)                                     \
+    do {                                                                         \
+        uint32_t got = glasses_detect_adv((data), sizeof(data));                 \
+        if(got != (uint32_t)(expected)) {                                        \
+            printf("FAIL %-28s reasons 0x%02lx, expected 0x%02lx\n",             \
+                   (label), (unsigned long)got, (unsigned long)(expected));      \
+            failures++;                                                          \
+        } else {                                                                 \
+            printf("ok   %-28s reasons 0x%02lx\n", (label), (unsigned long)got); \
+        }                                                                        \
+    } while(0)
+
+// Same layout as build_adv_data() in ray_ban_ble_emulator.c: Flags + 4-byte
+// manufacturer data (little-endian Company ID, two zero payload bytes)
+#define EMULATOR_PACKET(cid) \
+    {0x02, 0x01, 0x06, 0x05, 0xFF, (uint8_t)((cid) & 0xFF), (uint8_t)((cid) >> 8), 0x00, 0x00}
+
+int main(void) {
+    static const uint8_t meta_tech[] = EMULATOR_PACKET(GLASSES_CID_META_TECH);
+    static const uint8_t meta_inc[]  = EMULATOR_PACKET(GLASSES_CID_META_INC);
+    static const uint8_t luxottica[] = EMULATOR_PACKET(GLASSES_CID_LUXOTTICA);
+    static const uint8_t snap[]      = EMULATOR_PACKET(GLASSES_CID_SNAP);
+
+    CHECK_REASONS("emulator Meta Tech", meta_tech, GlassesReasonMetaTech);
+    CHECK_REASONS("emulator Meta Inc.", meta_inc, GlassesReasonMetaInc);
+    CHECK_REASONS("emulator Luxottica", luxottica, GlassesReasonLuxottica);
+    CHECK_REASONS("emulator Snap Spectacles", snap, GlassesReasonSnap);
+
+    // Complete local name only, mixed case: "Ray-Ban Meta"
+    static const uint8_t name_only[] = {
+        0x02, 0x01, 0x06,
+        0x0D, 0x09, 'R', 'a', 'y', '-', 'B', 'a', 'n', ' ', 'M', 'e', 't', 'a',
+    };
+    CHECK_REASONS("name only", name_only, GlassesReasonNameRayDashBan);
+
+    // Company ID and shortened name together combine both bits
+    static const uint8_t cid_and_name[] = {
+        0x05, 0xFF, 0xAB, 0x01, 0x00, 0x00,
+        0x07, 0x08, 'R', 'A', 'Y', 'B', 'A', 'N',
+    };
+    CHECK_REASONS("company ID + short name", cid_and_name,
+                  GlassesReasonMetaInc | GlassesReasonNameRayban);
+
+    // Unknown Company ID and an unrelated name
+    static const uint8_t unrelated[] = {
+        0x05, 0xFF, 0x4C, 0x00, 0x02, 0x15,
+        0x05, 0x09, 'P', 'h', 'o', 'n',
+    };
+    CHECK_REASONS("unrelated device", unrelated, GlassesReasonNone);
+
+    // The manufacturer structure claims 8 bytes but only 3 follow. Fields
+    // before it still count; the truncated one is ignored.
+    static const uint8_t truncated[] = {
+        0x07, 0x09, 'r', 'a', 'y', 'b', 'a', 'n',
+        0x08, 0xFF, 0xC2, 0x03,
+    };
+    CHECK_REASONS("truncated AD structure", truncated, GlassesReasonNameRayban);
+
+    GlassesAdv adv;
+    if(glasses_parse_adv(truncated, sizeof(truncated), &adv)) {
+        printf("FAIL %-28s parser accepted a truncated structure\n", "truncated AD structure");
+        failures++;
+    }
+
+    // Zero-length structure ends the payload (padding after the real data)
+    static const uint8_t padded[] = {
+        0x05, 0xFF, 0x53, 0x0D, 0x00, 0x00,
+        0x00, 0xFF, 0xAB, 0x01,
+    };
+    CHECK_REASONS("zero padding", padded, GlassesReasonLuxottica);
+
+    if(failures > 0) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all detection checks passed\n");
+    return 0;
+}
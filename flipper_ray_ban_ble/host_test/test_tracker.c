@@ -0,0 +1,253 @@
+/**
+ * Host check for the detector's device table — see glasses_tracker.h
+ *
+ * Feeds the tracker through a shim GlassesAdvSource, the same way a firmware
+ * port would, and checks top-N ordering, eviction and expiry (both also across
+ * tick wrap-around), the per-frame report cap and oversized reports. Ends with
+ * a rough throughput figure.
+ *
+ *   gcc -std=c99 -Wall -Wextra -Werror -I.. ../glasses_detect.c ../glasses_tracker.c \
+ *       test_tracker.c -o test_tracker
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "glasses_tracker.h"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                \
+    do {                                                           \
+        if(!(cond)) {                                              \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            failures++;                                            \
+        }                                                          \
+    } while(0)
+
+// ---------------------------------------------------------------------------
+// Shim adapter
+// ---------------------------------------------------------------------------
+
+#define SHIM_QUEUE_LEN 64
+
+typedef struct {
+    GlassesAdvReport reports[SHIM_QUEUE_LEN];
+    size_t           head;
+    size_t           count;
+} ShimSource;
+
+static bool shim_next(void* ctx, GlassesAdvReport* out) {
+    ShimSource* shim = ctx;
+    if(shim->head == shim->count) return false;
+    *out = shim->reports[shim->head++];
+    return true;
+}
+
+static void shim_reset(ShimSource* shim) {
+    shim->head  = 0;
+    shim->count = 0;
+}
+
+// Queues a Flags + manufacturer data advertisement from device `id`
+static void shim_push(ShimSource* shim, uint8_t id, uint16_t cid, int8_t rssi) {
+    GlassesAdvReport* r = &shim->reports[shim->count++];
+    static const uint8_t base_addr[GLASSES_ADDR_LEN] = {0xC0, 0xFF, 0xEE, 0x00, 0x00, 0x00};
+    for(uint8_t i = 0; i < GLASSES_ADDR_LEN; i++) r->addr[i] = base_addr[i];
+    r->addr[GLASSES_ADDR_LEN - 1] = id;
+    r->rssi = rssi;
+
+    uint8_t i    = 0;
+    r->data[i++] = 0x02;
+    r->data[i++] = 0x01;
+    r->data[i++] = 0x06;
+    r->data[i++] = 0x05;
+    r->data[i++] = 0xFF;
+    r->data[i++] = (uint8_t)(cid & 0xFF);
+    r->data[i++] = (uint8_t)(cid >> 8);
+    r->data[i++] = 0x00;
+    r->data[i++] = 0x00;
+    r->len       = i;
+}
+
+static uint8_t device_id(const GlassesDevice* d) {
+    return d->addr[GLASSES_ADDR_LEN - 1];
+}
+
+static const GlassesDevice* find_device(const GlassesTracker* tracker, uint8_t id) {
+    for(size_t i = 0; i < GLASSES_TRACKER_CAPACITY; i++) {
+        const GlassesDevice* d = &tracker->devices[i];
+        if(d->used && device_id(d) == id) return d;
+    }
+    return NULL;
+}
+
+// ---------------------------------------------------------------------------
+// Checks
+// ---------------------------------------------------------------------------
+
+static void check_top_ordering(void) {
+    static GlassesTracker tracker;
+    static ShimSource     shim;
+    glasses_tracker_init(&tracker);
+    shim_reset(&shim);
+
+    shim_push(&shim, 1, GLASSES_CID_META_INC, -80);
+    shim_push(&shim, 2, GLASSES_CID_SNAP, -40);
+    shim_push(&shim, 3, 0x004C, -30); // not glasses: must not be recorded
+    shim_push(&shim, 4, GLASSES_CID_LUXOTTICA, -60);
+    shim_push(&shim, 5, GLASSES_CID_META_TECH, -50);
+    shim_push(&shim, 6, GLASSES_CID_META_INC, -90);
+
+    CHECK(glasses_tracker_drain(&tracker, shim_next, &shim, 1000) == 6);
+    CHECK(tracker.total_hits == 5);
+    CHECK(find_device(&tracker, 3) == NULL);
+
+    const GlassesDevice* top[GLASSES_TRACKER_TOP_N];
+    size_t n = glasses_tracker_top(&tracker, top, GLASSES_TRACKER_TOP_N);
+    CHECK(n == GLASSES_TRACKER_TOP_N);
+    if(n == GLASSES_TRACKER_TOP_N) {
+        CHECK(device_id(top[0]) == 2);
+        CHECK(device_id(top[1]) == 5);
+        CHECK(device_id(top[2]) == 4);
+        CHECK(device_id(top[3]) == 1);
+        CHECK(top[0]->reasons == GlassesReasonSnap);
+        CHECK(top[0]->company_id == GLASSES_CID_SNAP);
+    }
+
+    // Repeated weak reports pull device 2's smoothed RSSI below device 5
+    shim_reset(&shim);
+    for(int i = 0; i < 10; i++) shim_push(&shim, 2, GLASSES_CID_SNAP, -95);
+    glasses_tracker_drain(&tracker, shim_next, &shim, 1100);
+    n = glasses_tracker_top(&tracker, top, 2);
+    CHECK(n == 2);
+    if(n == 2) {
+        CHECK(device_id(top[0]) == 5);
+        CHECK(device_id(top[1]) == 4);
+    }
+    CHECK(find_device(&tracker, 2)->hits == 11);
+    CHECK(find_device(&tracker, 2)->rssi_last == -95);
+}
+
+static void check_eviction(uint32_t t0) {
+    static GlassesTracker tracker;
+    static ShimSource     shim;
+    glasses_tracker_init(&tracker);
+
+    // Fill the table; device `id` is last seen at time t0 + id
+    for(uint8_t id = 1; id <= GLASSES_TRACKER_CAPACITY; id++) {
+        shim_reset(&shim);
+        shim_push(&shim, id, GLASSES_CID_META_INC, -60);
+        glasses_tracker_drain(&tracker, shim_next, &shim, t0 + id);
+    }
+
+    // Refresh device 1 so device 2 becomes the least recently seen
+    shim_reset(&shim);
+    shim_push(&shim, 1, GLASSES_CID_META_INC, -60);
+    glasses_tracker_drain(&tracker, shim_next, &shim, t0 + 100);
+
+    shim_reset(&shim);
+    shim_push(&shim, 200, GLASSES_CID_SNAP, -60);
+    glasses_tracker_drain(&tracker, shim_next, &shim, t0 + 101);
+
+    CHECK(find_device(&tracker, 1) != NULL);
+    CHECK(find_device(&tracker, 2) == NULL);
+    CHECK(find_device(&tracker, 3) != NULL);
+    CHECK(find_device(&tracker, GLASSES_TRACKER_CAPACITY) != NULL);
+    CHECK(find_device(&tracker, 200) != NULL);
+    CHECK(find_device(&tracker, 200)->hits == 1);
+}
+
+static void check_expiry(void) {
+    static GlassesTracker tracker;
+    static ShimSource     shim;
+    glasses_tracker_init(&tracker);
+    shim_reset(&shim);
+
+    // Start close to the tick counter wrap so expiry is checked across it
+    const uint32_t t0 = 0xFFFFF000u;
+    shim_push(&shim, 1, GLASSES_CID_META_INC, -60);
+    glasses_tracker_drain(&tracker, shim_next, &shim, t0);
+
+    shim_reset(&shim);
+    shim_push(&shim, 2, GLASSES_CID_META_INC, -60);
+    glasses_tracker_drain(&tracker, shim_next, &shim, t0 + 20000);
+
+    glasses_tracker_expire(&tracker, t0 + GLASSES_TRACKER_MAX_AGE_MS, GLASSES_TRACKER_MAX_AGE_MS);
+    CHECK(find_device(&tracker, 1) != NULL);
+
+    glasses_tracker_expire(&tracker, t0 + GLASSES_TRACKER_MAX_AGE_MS + 1, GLASSES_TRACKER_MAX_AGE_MS);
+    CHECK(find_device(&tracker, 1) == NULL);
+    CHECK(find_device(&tracker, 2) != NULL);
+
+    const GlassesDevice* top[GLASSES_TRACKER_TOP_N];
+    CHECK(glasses_tracker_top(&tracker, top, GLASSES_TRACKER_TOP_N) == 1);
+}
+
+static void check_frame_cap_and_oversized_reports(void) {
+    static GlassesTracker tracker;
+    static ShimSource     shim;
+    glasses_tracker_init(&tracker);
+    shim_reset(&shim);
+
+    for(uint8_t i = 0; i < SHIM_QUEUE_LEN; i++) shim_push(&shim, i, GLASSES_CID_META_INC, -60);
+    CHECK(glasses_tracker_drain(&tracker, shim_next, &shim, 1) == GLASSES_TRACKER_MAX_REPORTS_PER_FRAME);
+    CHECK(shim.head == GLASSES_TRACKER_MAX_REPORTS_PER_FRAME);
+    CHECK(glasses_tracker_drain(&tracker, NULL, NULL, 1) == 0);
+
+    // An adapter claiming more bytes than the report holds must not over-read.
+    // Under -fsanitize=address this would fault without the clamp.
+    GlassesAdvReport r;
+    shim_reset(&shim);
+    shim_push(&shim, 99, GLASSES_CID_LUXOTTICA, -60);
+    r = shim.reports[0];
+    // Fill the rest of the buffer with one AD structure ending exactly at its
+    // end, so an unclamped parser walks on to the byte after `data`
+    r.data[r.len]     = (uint8_t)(GLASSES_ADV_MAX_LEN - r.len - 1);
+    r.data[r.len + 1] = 0x16; // Service Data, ignored by the parser
+    for(uint8_t i = (uint8_t)(r.len + 2); i < GLASSES_ADV_MAX_LEN; i++) r.data[i] = 0xAA;
+    r.len = 255;
+    CHECK(glasses_tracker_feed(&tracker, &r, 2) == GlassesReasonLuxottica);
+}
+
+static void report_throughput(void) {
+    static GlassesTracker tracker;
+    static ShimSource     shim;
+    glasses_tracker_init(&tracker);
+    shim_reset(&shim);
+    for(uint8_t i = 0; i < SHIM_QUEUE_LEN; i++) {
+        shim_push(&shim, i, (i % 4) ? GLASSES_CID_META_INC : 0x004C, (int8_t)(-40 - i));
+    }
+
+    const uint32_t rounds = 200000;
+    clock_t start         = clock();
+    for(uint32_t round = 0; round < rounds; round++) {
+        for(size_t i = 0; i < SHIM_QUEUE_LEN; i++) {
+            glasses_tracker_feed(&tracker, &shim.reports[i], round);
+        }
+    }
+    double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    const GlassesDevice* top[GLASSES_TRACKER_TOP_N];
+    glasses_tracker_top(&tracker, top, GLASSES_TRACKER_TOP_N);
+    printf("feed: %.0f ns per report (%lu reports)\n",
+           secs * 1e9 / ((double)rounds * SHIM_QUEUE_LEN),
+           (unsigned long)rounds * SHIM_QUEUE_LEN);
+}
+
+int main(void) {
+    check_top_ordering();
+    check_eviction(0);
+    // Half the table is filled before the tick counter wraps and half after
+    check_eviction(0xFFFFFFFFu - GLASSES_TRACKER_CAPACITY / 2);
+    check_expiry();
+    check_frame_cap_and_oversized_reports();
+
+    if(failures > 0) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all tracker checks passed\n");
+    report_throughput();
+    return 0;
+}
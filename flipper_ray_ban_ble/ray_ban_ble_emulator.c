@@ -9,6 +9,10 @@
  * Uses the Flipper Zero Extra Beacon API (furi_hal_bt_extra_beacon_*) to
  * transmit non-connectable BLE advertisements.
  *
+ * The detector screen runs the shared detection core (glasses_tracker.c) on
+ * advertisements delivered by a platform adapter and lists the strongest
+ * smart glasses seen.
+ *
  * Flipper Zero screen: 128x64 pixels
  */
 
@@ -21,6 +25,9 @@
 #include <notification/notification.h>
 #include <notification/notification_messages.h>
 
+#include "glasses_detect.h"
+#include "glasses_tracker.h"
+
 #define TAG "RayBanBLE"
 
 // ---------------------------------------------------------------------------
@@ -31,8 +38,7 @@ typedef struct {
     const char* short_name;  // Fits in the menu list
     const char* long_name;   // Shown on the advertising screen
     const char* cid_str;     // Human-readable CID
-    uint8_t     cid_lo;      // Company ID low byte (little-endian BLE)
-    uint8_t     cid_hi;      // Company ID high byte (little-endian BLE)
+    uint16_t    cid;         // Company ID (sent little-endian)
 } DeviceProfile;
 
 typedef enum {
@@ -44,10 +50,10 @@ typedef enum {
 } DeviceIndex;
 
 static const DeviceProfile kDevices[DeviceCount] = {
-    [DeviceMeta2]     = {"Meta Tech",      "Meta Platforms Tech",  "0x058E", 0x8E, 0x05},
-    [DeviceMeta1]     = {"Meta Inc.",      "Meta Platforms, Inc.", "0x01AB", 0xAB, 0x01},
-    [DeviceLuxottica] = {"Luxottica",      "EssilorLuxottica",     "0x0D53", 0x53, 0x0D},
-    [DeviceSnap]      = {"Snap Spectacles","Snapchat, Inc.",        "0x03C2", 0xC2, 0x03},
+    [DeviceMeta2]     = {"Meta Tech",      "Meta Platforms Tech",  "0x058E", GLASSES_CID_META_TECH},
+    [DeviceMeta1]     = {"Meta Inc.",      "Meta Platforms, Inc.", "0x01AB", GLASSES_CID_META_INC},
+    [DeviceLuxottica] = {"Luxottica",      "EssilorLuxottica",     "0x0D53", GLASSES_CID_LUXOTTICA},
+    [DeviceSnap]      = {"Snap Spectacles","Snapchat, Inc.",        "0x03C2", GLASSES_CID_SNAP},
 };
 
 // Random-looking static MAC address used for the emulated device.
@@ -61,6 +67,7 @@ static const uint8_t kEmulatedMac[EXTRA_BEACON_MAC_ADDR_SIZE] = {0x5E, 0x9A, 0x3
 typedef enum {
     ScreenMenu,
     ScreenAdvertising,
+    ScreenDetect,
 } AppScreen;
 
 typedef struct {
@@ -68,6 +75,13 @@ typedef struct {
     DeviceIndex  selected;
     bool         advertising;
 
+    // Detector mode. The tracker is written by the app loop and read by the
+    // draw callback, so both hold `mutex`.
+    GlassesTracker   tracker;
+    GlassesAdvSource adv_source;     // NULL if the firmware can't deliver scan results
+    void*            adv_source_ctx;
+    FuriMutex*       mutex;
+
     Gui*              gui;
     ViewPort*         view_port;
     FuriMessageQueue* event_queue;
@@ -84,7 +98,7 @@ typedef struct {
  *   AD[1]: Manufacturer Specific Data — Company ID (little-endian) + 2-byte payload
  *
  * CoreBluetooth parses bytes [0..1] of Manufacturer Specific Data as the
- * Company ID (UInt16, little-endian). That's exactly what we place at cid_lo/cid_hi.
+ * Company ID (UInt16, little-endian). That's exactly what we place after the type byte.
  *
  * Max BLE legacy advertisement: 31 bytes. This packet is 9 bytes.
  */
@@ -99,8 +113,8 @@ static uint8_t build_adv_data(const DeviceProfile* p, uint8_t out[EXTRA_BEACON_M
     // AD Element: Manufacturer Specific Data (6 bytes)
     out[i++] = 0x05;      // Length (type + 2-byte CID + 2-byte payload)
     out[i++] = 0xFF;      // Type: Manufacturer Specific
-    out[i++] = p->cid_lo; // Company ID low byte
-    out[i++] = p->cid_hi; // Company ID high byte
+    out[i++] = (uint8_t)(p->cid & 0xFF); // Company ID low byte
+    out[i++] = (uint8_t)(p->cid >> 8);   // Company ID high byte
     out[i++] = 0x00;      // Payload byte 1 (placeholder)
     out[i++] = 0x00;      // Payload byte 2 (placeholder)
 
@@ -116,6 +130,8 @@ static void ble_start(App* app) {
     // Set advertisement data
     uint8_t adv_data[EXTRA_BEACON_MAX_DATA_SIZE];
     uint8_t adv_len = build_adv_data(p, adv_data);
+    // What we broadcast must trip the same detection logic the apps use
+    furi_assert(glasses_detect_adv(adv_data, adv_len) != GlassesReasonNone);
     furi_hal_bt_extra_beacon_set_data(adv_data, adv_len);
 
     // Configure beacon: 100-200ms interval, all channels, max power, random static MAC
@@ -146,10 +162,58 @@ static void ble_stop(App* app) {
     FURI_LOG_I(TAG, "BLE beacon stopped");
 }
 
+// ---------------------------------------------------------------------------
+// Detector
+// ---------------------------------------------------------------------------
+
+// Called once per frame (~100 ms) while the detector screen is open
+static void detect_tick(App* app) {
+    uint32_t now = furi_get_tick();
+
+    furi_mutex_acquire(app->mutex, FuriWaitForever);
+    glasses_tracker_drain(&app->tracker, app->adv_source, app->adv_source_ctx, now);
+    glasses_tracker_expire(&app->tracker, now, GLASSES_TRACKER_MAX_AGE_MS);
+    furi_mutex_release(app->mutex);
+}
+
 // ---------------------------------------------------------------------------
 // Drawing
 // ---------------------------------------------------------------------------
 
+static void draw_detect(Canvas* canvas, App* app) {
+    char buf[32];
+
+    canvas_set_font(canvas, FontPrimary);
+    canvas_draw_str(canvas, 2, 10, "Nearby Glasses");
+    canvas_draw_line(canvas, 0, 12, 128, 12);
+
+    canvas_set_font(canvas, FontSecondary);
+    const GlassesDevice* top[GLASSES_TRACKER_TOP_N];
+
+    furi_mutex_acquire(app->mutex, FuriWaitForever);
+    size_t count = glasses_tracker_top(&app->tracker, top, GLASSES_TRACKER_TOP_N);
+
+    snprintf(buf, sizeof(buf), "%lu", (unsigned long)app->tracker.total_hits);
+    canvas_draw_str_aligned(canvas, 126, 10, AlignRight, AlignBottom, buf);
+
+    if(count == 0) {
+        canvas_draw_str(canvas, 2, 28, "Listening...");
+    }
+    for(size_t i = 0; i < count; i++) {
+        uint8_t y         = (uint8_t)(22 + i * 10);
+        const char* label = glasses_company_name(top[i]->company_id);
+        canvas_draw_str(canvas, 2, y, label != NULL ? label : "Name match");
+
+        snprintf(buf, sizeof(buf), "%d dBm", top[i]->rssi_q4 / (1 << GLASSES_RSSI_Q4_SHIFT));
+        canvas_draw_str_aligned(canvas, 126, y, AlignRight, AlignBottom, buf);
+    }
+    furi_mutex_release(app->mutex);
+
+    // Footer
+    canvas_draw_line(canvas, 0, 54, 128, 54);
+    canvas_draw_str(canvas, 2, 63, "[Back] Menu");
+}
+
 static void draw_callback(Canvas* canvas, void* ctx) {
     App* app = ctx;
     canvas_clear(canvas);
@@ -181,7 +245,15 @@ static void draw_callback(Canvas* canvas, void* ctx) {
         // Footer
         canvas_draw_line(canvas, 0, 54, 128, 54);
         canvas_set_font(canvas, FontSecondary);
-        canvas_draw_str(canvas, 2, 63, "[Ok] Advertise  [Bk] Exit");
+        // The detector is only offered when the firmware delivers scan results
+        if(app->adv_source != NULL) {
+            canvas_draw_str(canvas, 2, 63, "[Ok]Adv [>]Detect [Bk]Exit");
+        } else {
+            canvas_draw_str(canvas, 2, 63, "[Ok] Advertise  [Bk] Exit");
+        }
+
+    } else if(app->screen == ScreenDetect) {
+        draw_detect(canvas, app);
 
     } else {  // ScreenAdvertising
         const DeviceProfile* p = &kDevices[app->selected];
@@ -234,6 +306,13 @@ static App* app_alloc() {
     app->selected    = DeviceMeta2;
     app->advertising = false;
 
+    glasses_tracker_init(&app->tracker);
+    // Stock firmware exposes no BLE observer API to apps; a firmware or
+    // sensor build that can deliver raw advertisements plugs its adapter in here.
+    app->adv_source     = NULL;
+    app->adv_source_ctx = NULL;
+    app->mutex          = furi_mutex_alloc(FuriMutexTypeNormal);
+
     app->event_queue  = furi_message_queue_alloc(8, sizeof(InputEvent));
     app->notification = furi_record_open(RECORD_NOTIFICATION);
 
@@ -256,6 +335,7 @@ static void app_free(App* app) {
 
     furi_record_close(RECORD_NOTIFICATION);
     furi_message_queue_free(app->event_queue);
+    furi_mutex_free(app->mutex);
 
     free(app);
 }
@@ -273,6 +353,7 @@ int32_t ray_ban_ble_app(void* p) {
 
     while(running) {
         if(furi_message_queue_get(app->event_queue, &event, 100) != FuriStatusOk) {
+            if(app->screen == ScreenDetect) detect_tick(app);
             view_port_update(app->view_port);
             continue;
         }
@@ -291,12 +372,17 @@ int32_t ray_ban_ble_app(void* p) {
                 ble_start(app);
                 if(app->advertising) app->screen = ScreenAdvertising;
                 break;
+            case InputKeyRight:
+                if(app->adv_source != NULL) app->screen = ScreenDetect;
+                break;
             case InputKeyBack:
                 running = false;
                 break;
             default:
                 break;
             }
+        } else if(app->screen == ScreenDetect) {
+            if(event.key == InputKeyBack) app->screen = ScreenMenu;
         } else {
             if(event.key == InputKeyBack) {
                 ble_stop(app);